@@ -5,10 +5,28 @@
 #include <string.h>
 #include <stdio.h>
 #include <assert.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdatomic.h>
 #include "ldyna.h"
 
 typedef unsigned char ldyna_Byte;
 
+// Segment 's' of a list in concurrent append mode holds
+// (1 << (s + LDYNA_SEGMENT_SHIFT)) objects, so the segments
+// directory covers the whole size_t range.
+#define LDYNA_SEGMENT_SHIFT 6
+#define LDYNA_SEGMENTS (sizeof(size_t) * CHAR_BIT - LDYNA_SEGMENT_SHIFT)
+#define LDYNA_CACHE_LINE 64
+
+// Producers hammer 'reserved', publishers 'published' and readers load
+// 'published' and 'dir': each lives on its own cache line.
+struct _ldyna_segments {
+    _Alignas(LDYNA_CACHE_LINE) atomic_size_t reserved;   // slots handed out to producers
+    _Alignas(LDYNA_CACHE_LINE) atomic_size_t published;  // slots visible to readers
+    _Alignas(LDYNA_CACHE_LINE) _Atomic(ldyna_Byte *) dir[LDYNA_SEGMENTS];
+};
+
 struct _ldyna {
     size_t allocs;          // actual number of objects in the array
     size_t len;             // total size of the array
@@ -16,14 +34,28 @@ struct _ldyna {
     ldyna_compare compare;
     ldyna_flags flags;
     ldyna_Byte *array;
+    struct _ldyna_segments *segments;  // non-NULL in concurrent append mode
 };
 
 static const size_t ldyna_block_size = 61;
+static const size_t ldyna_select_cutoff = 16;
 
 static void __std_msg(FILE *, const char *restrict, bool);
 static int __default_compare(const void *, const void *);
 static bool __bsearch_index_insert(const void *, size_t, size_t, const void *, size_t *, bool, int (*)(const void *, const void *));
 static void __list_remove(ldyna *, size_t);
+static int __list_reserve(ldyna *, size_t);
+static void __swap(ldyna_Byte *, ldyna_Byte *, size_t);
+static void __sift_down(ldyna_Byte *, size_t, size_t, size_t, int, ldyna_compare);
+static void __heap_select(ldyna_Byte *, size_t, size_t, size_t, ldyna_compare);
+static size_t __partition(ldyna_Byte *, size_t, size_t, size_t, ldyna_compare);
+static void __insertion_sort(ldyna_Byte *, size_t, size_t, size_t, ldyna_compare);
+static void __introselect(ldyna_Byte *, size_t, size_t, size_t, ldyna_compare);
+static size_t __segment_index(size_t, size_t *);
+static ldyna_Byte *__segment_get(struct _ldyna_segments *, size_t, size_t, bool);
+static void __segments_free(struct _ldyna_segments *);
+static void __concurrent_publish(struct _ldyna_segments *, size_t);
+static int __concurrent_append(ldyna *, void *);
 
 #define ldyna_perror(stream, func, msg, isstd)                          \
     fprintf(stream, "[ldyna]:%s:%s:%lu", __FILE__, func, __LINE__+0UL); \
@@ -60,26 +92,20 @@ static bool __bsearch_index_insert(const void *base, size_t nelems, size_t width
             left = mid + 1;
         }
     }
-    size_t retidx = right - 1;
+    // 'right' is the first index whose object compares greater than key
 
-    int equal = compare(key, ((ldyna_Byte *) base) + retidx * width);
     if (isinsert) {
-        if (equal > 0) { // insert after index
-            ++retidx;
-        }
-        // Stable insertion
-        while (retidx < right && !equal) {
-            ++retidx;
-            equal = compare(key, ((ldyna_Byte *) base) + retidx * width);
-        }
+        // Stable insertion, after the objects that compare equal
+        *idx = right;
+        return true;
     }
-    else {
-        if (equal) {   // not equal, can't find object
-            return false;
-        }
+
+    // Empty list, or key less than every object: can't find object
+    if (!right || compare(key, ((ldyna_Byte *) base) + (right - 1) * width)) {
+        return false;
     }
 
-    *idx = retidx;
+    *idx = right - 1;
     return true;
 }
 
@@ -93,6 +119,287 @@ static void __list_remove(ldyna *list, size_t idx)
     memmove(list->array + idx * list->esize, list->array + (idx + 1) * list->esize, (list->len - idx) * list->esize);
 }
 
+static int __list_reserve(ldyna *list, size_t nelems)
+{
+    if (list->allocs >= nelems) {
+        return LDYNA_SUCCESS;
+    }
+
+    if (nelems > SIZE_MAX - ldyna_block_size) {
+        ldyna_perror(stderr, __func__, "size_t overflow\n", false);
+        return LDYNA_REALLOC_ERR;
+    }
+    // Keep the capacity a multiple of the block size, as ldyna_insert does
+    size_t allocs = ((nelems + ldyna_block_size - 1) / ldyna_block_size) * ldyna_block_size;
+    if (allocs > SIZE_MAX / list->esize) {
+        ldyna_perror(stderr, __func__, "size_t overflow\n", false);
+        return LDYNA_REALLOC_ERR;
+    }
+    ldyna_Byte *tmp = realloc(list->array, sizeof(*tmp) * allocs * list->esize);
+    if (!tmp) {
+        ldyna_perror(stderr, __func__, "realloc failed", true);
+        return LDYNA_REALLOC_ERR;
+    }
+    list->array = tmp;
+    list->allocs = allocs;
+    return LDYNA_SUCCESS;
+}
+
+static void __swap(ldyna_Byte *a, ldyna_Byte *b, size_t width)
+{
+    if (a == b) {
+        return;
+    }
+    for (size_t i = 0; i < width; i++) {
+        ldyna_Byte tmp = a[i];
+        a[i] = b[i];
+        b[i] = tmp;
+    }
+}
+
+// Restores the heap property of the subtree rooted at 'idx'. With
+// 'order' > 0 the heap is a max-heap, with 'order' < 0 a min-heap.
+// The direction swaps the arguments of compare: negating its result
+// would overflow on INT_MIN.
+static inline bool __heap_above(const ldyna_Byte *a, const ldyna_Byte *b, int order, ldyna_compare compare)
+{
+    return order > 0 ? compare(a, b) > 0 : compare(b, a) > 0;
+}
+
+static void __sift_down(ldyna_Byte *base, size_t nelems, size_t idx, size_t width, int order, ldyna_compare compare)
+{
+    for (;;) {
+        size_t top = idx;
+        size_t child = 2 * idx + 1;
+        if (child < nelems && __heap_above(base + child * width, base + top * width, order, compare)) {
+            top = child;
+        }
+        child++;
+        if (child < nelems && __heap_above(base + child * width, base + top * width, order, compare)) {
+            top = child;
+        }
+        if (top == idx) {
+            return;
+        }
+        __swap(base + idx * width, base + top * width, width);
+        idx = top;
+    }
+}
+
+// Fallback of the introselect when the partitioning degenerates:
+// keeps the nth+1 smallest objects in a max-heap, O(n log nth).
+static void __heap_select(ldyna_Byte *base, size_t nelems, size_t nth, size_t width, ldyna_compare compare)
+{
+    size_t heaplen = nth + 1;
+    for (size_t i = heaplen / 2; i-- > 0; ) {
+        __sift_down(base, heaplen, i, width, 1, compare);
+    }
+    for (size_t i = heaplen; i < nelems; i++) {
+        if (compare(base + i * width, base) < 0) {
+            __swap(base + i * width, base, width);
+            __sift_down(base, heaplen, 0, width, 1, compare);
+        }
+    }
+    __swap(base, base + nth * width, width);
+}
+
+// Hoare partition of [lo, hi) around a median-of-three pivot. Returns
+// the final index of the pivot.
+static size_t __partition(ldyna_Byte *base, size_t lo, size_t hi, size_t width, ldyna_compare compare)
+{
+    ldyna_Byte *first = base + lo * width;
+    ldyna_Byte *mid = base + (lo + (hi - lo) / 2) * width;
+    ldyna_Byte *last = base + (hi - 1) * width;
+
+    if (compare(mid, first) < 0) {
+        __swap(mid, first, width);
+    }
+    if (compare(last, first) < 0) {
+        __swap(last, first, width);
+    }
+    if (compare(last, mid) < 0) {
+        __swap(last, mid, width);
+    }
+    // Move the median to the front, it stays there until the end
+    __swap(first, mid, width);
+
+    size_t i = lo + 1;
+    size_t j = hi - 1;
+    for (;;) {
+        while (i <= j && compare(base + i * width, first) < 0) {
+            i++;
+        }
+        while (i <= j && compare(base + j * width, first) > 0) {
+            j--;
+        }
+        if (i >= j) {
+            break;
+        }
+        __swap(base + i * width, base + j * width, width);
+        i++;
+        j--;
+    }
+    __swap(first, base + j * width, width);
+    return j;
+}
+
+static void __insertion_sort(ldyna_Byte *base, size_t lo, size_t hi, size_t width, ldyna_compare compare)
+{
+    for (size_t i = lo + 1; i < hi; i++) {
+        for (size_t j = i; j > lo && compare(base + j * width, base + (j - 1) * width) < 0; j--) {
+            __swap(base + j * width, base + (j - 1) * width, width);
+        }
+    }
+}
+
+static void __introselect(ldyna_Byte *base, size_t nelems, size_t nth, size_t width, ldyna_compare compare)
+{
+    size_t lo = 0;
+    size_t hi = nelems;
+
+    // Allow 2*log2(n) partitioning rounds before falling back to heap select
+    size_t depth = 0;
+    for (size_t n = nelems; n > 1; n >>= 1) {
+        depth += 2;
+    }
+
+    while (hi - lo > ldyna_select_cutoff) {
+        if (!depth--) {
+            __heap_select(base + lo * width, hi - lo, nth - lo, width, compare);
+            return;
+        }
+        size_t pivot = __partition(base, lo, hi, width, compare);
+        if (pivot == nth) {
+            return;
+        }
+        if (nth < pivot) {
+            hi = pivot;
+        }
+        else {
+            lo = pivot + 1;
+        }
+    }
+    __insertion_sort(base, lo, hi, width, compare);
+}
+
+static inline size_t __segment_capacity(size_t seg)
+{
+    return (size_t) 1 << (seg + LDYNA_SEGMENT_SHIFT);
+}
+
+// The ready flags of a segment are stored right after its objects
+static inline atomic_uchar *__segment_ready(ldyna_Byte *segment, size_t seg, size_t width)
+{
+    return (atomic_uchar *) (segment + __segment_capacity(seg) * width);
+}
+
+// Maps a list index to its segment and the offset inside of it
+static size_t __segment_index(size_t idx, size_t *offset)
+{
+    size_t q = idx + ((size_t) 1 << LDYNA_SEGMENT_SHIFT);
+    size_t msb;
+#if defined(__GNUC__)
+    msb = sizeof(unsigned long long) * CHAR_BIT - 1 - __builtin_clzll(q);
+#else
+    msb = 0;
+    for (size_t tmp = q; tmp >>= 1; ) {
+        msb++;
+    }
+#endif
+    *offset = q - ((size_t) 1 << msb);
+    return msb - LDYNA_SEGMENT_SHIFT;
+}
+
+// Returns the segment 'seg', allocating it if 'alloc' is set. Returns
+// NULL if the allocation fails, so that the next producer retries it.
+// Segments never move once in the directory.
+static ldyna_Byte *__segment_get(struct _ldyna_segments *segments, size_t seg, size_t width, bool alloc)
+{
+    ldyna_Byte *segment = atomic_load_explicit(&segments->dir[seg], memory_order_acquire);
+    if (segment || !alloc) {
+        return segment;
+    }
+
+    ldyna_Byte *fresh = calloc(__segment_capacity(seg), width + sizeof(atomic_uchar));
+    if (!fresh) {
+        ldyna_perror(stderr, __func__, "calloc failed", true);
+        return NULL;
+    }
+    // Another producer may have raced us to this segment
+    if (!atomic_compare_exchange_strong_explicit(&segments->dir[seg], &segment, fresh,
+                                                 memory_order_acq_rel, memory_order_acquire)) {
+        free(fresh);
+        return segment;
+    }
+    return fresh;
+}
+
+static void __segments_free(struct _ldyna_segments *segments)
+{
+    for (size_t seg = 0; seg < LDYNA_SEGMENTS; seg++) {
+        free(atomic_load_explicit(&segments->dir[seg], memory_order_relaxed));
+    }
+    free(segments);
+}
+
+// Tells if a slot below the published length holds an object. The
+// other published slots are tombstones of failed appends.
+static bool __slot_is_ready(struct _ldyna_segments *segments, size_t idx, size_t width)
+{
+    size_t offset;
+    size_t seg = __segment_index(idx, &offset);
+    ldyna_Byte *segment = __segment_get(segments, seg, width, false);
+    return segment && atomic_load_explicit(&__segment_ready(segment, seg, width)[offset], memory_order_acquire);
+}
+
+// Advances the published length over every consecutive slot that is
+// ready. Whoever completes the slot at the published length moves it.
+static void __concurrent_publish(struct _ldyna_segments *segments, size_t width)
+{
+    for (;;) {
+        // Orders our ready flag store (or published CAS) before the
+        // loads below, so that of two producers completing neighbour
+        // slots at least one sees the other and none is left behind.
+        atomic_thread_fence(memory_order_seq_cst);
+
+        size_t len = atomic_load_explicit(&segments->published, memory_order_acquire);
+        if (len >= atomic_load_explicit(&segments->reserved, memory_order_relaxed)) {
+            return;
+        }
+        if (!__slot_is_ready(segments, len, width)) {
+            return;
+        }
+        atomic_compare_exchange_strong_explicit(&segments->published, &len, len + 1,
+                                                memory_order_release, memory_order_relaxed);
+    }
+}
+
+static int __concurrent_append(ldyna *list, void *data)
+{
+    struct _ldyna_segments *segments = list->segments;
+
+    size_t idx = atomic_fetch_add_explicit(&segments->reserved, 1, memory_order_relaxed);
+    size_t offset;
+    size_t seg = __segment_index(idx, &offset);
+    ldyna_Byte *segment = __segment_get(segments, seg, list->esize, true);
+    if (!segment) {
+        // The slot becomes a tombstone: nobody else can publish it, so
+        // wait for the earlier slots and move the published length past
+        // it ourselves. The earlier producers never wait on us.
+        while (atomic_load_explicit(&segments->published, memory_order_acquire) != idx) {
+            ;
+        }
+        atomic_store_explicit(&segments->published, idx + 1, memory_order_release);
+        __concurrent_publish(segments, list->esize);
+        return LDYNA_REALLOC_ERR;
+    }
+
+    memcpy(segment + offset * list->esize, data, list->esize);
+    atomic_store_explicit(&__segment_ready(segment, seg, list->esize)[offset], 1, memory_order_release);
+    __concurrent_publish(segments, list->esize);
+    return LDYNA_SUCCESS;
+}
+
 ldyna *ldyna_create(size_t esize, ldyna_compare compare, ldyna_flags flags)
 {
     assert(esize);
@@ -102,6 +409,29 @@ ldyna *ldyna_create(size_t esize, ldyna_compare compare, ldyna_flags flags)
         ldyna_perror(stderr, __func__, "malloc failed", true);
         return NULL;
     }
+    list->esize = esize;
+    list->flags = flags;
+    list->compare = compare ? compare : __default_compare;
+    list->len = 0;
+
+    if (flags & LDYNA_CONCURRENT_APPEND) {
+        list->array = NULL;
+        list->allocs = 0;
+        list->segments = aligned_alloc(LDYNA_CACHE_LINE, sizeof(*list->segments));
+        if (!list->segments) {
+            free(list);
+            ldyna_perror(stderr, __func__, "malloc failed", true);
+            return NULL;
+        }
+        atomic_init(&list->segments->reserved, 0);
+        atomic_init(&list->segments->published, 0);
+        for (size_t seg = 0; seg < LDYNA_SEGMENTS; seg++) {
+            atomic_init(&list->segments->dir[seg], NULL);
+        }
+        return list;
+    }
+
+    list->segments = NULL;
     // TODO: check size_t overflow
     list->array = malloc(sizeof(*list->array) * ldyna_block_size * esize);
     if (!list->array) {
@@ -110,26 +440,18 @@ ldyna *ldyna_create(size_t esize, ldyna_compare compare, ldyna_flags flags)
     }
 
     list->allocs = ldyna_block_size;
-    list->len = 0;
-    list->esize = esize;
-    list->flags = flags;
-
-    if (compare) {
-        list->compare = compare;
-    }
-    else {
-        list->compare = __default_compare;
-    }
-
     return list;
 }
 
 int ldyna_destroy(ldyna **list)
 {
-    if (!*list || !(*list)->array) {
+    if (!*list || (!(*list)->array && !(*list)->segments)) {
         return LDYNA_NULLPTR_WARN;
     }
 
+    if ((*list)->segments) {
+        __segments_free((*list)->segments);
+    }
     free((*list)->array);
     (*list)->array = NULL;
     free(*list);
@@ -142,16 +464,31 @@ size_t ldyna_len(ldyna *list)
     if (!list) {
         return 0;
     }
+    if (list->flags & LDYNA_CONCURRENT_APPEND) {
+        return atomic_load_explicit(&list->segments->published, memory_order_acquire);
+    }
     return list->len;
 }
 
 int ldyna_append(ldyna *list, void *data, ldyna_inbulk inbulk)
 {
+    if (list && (list->flags & LDYNA_CONCURRENT_APPEND)) {
+        if (!data) {
+            return LDYNA_NULLPTR_WARN;
+        }
+        if (inbulk.inbulk) {
+            return LDYNA_INBULK_WARN;
+        }
+        return __concurrent_append(list, data);
+    }
     return ldyna_insert(list, data, list->len, inbulk);
 }
 
 int ldyna_insert(ldyna *list, void *data, size_t idx, ldyna_inbulk inbulk)
 {
+    if (list && (list->flags & LDYNA_CONCURRENT_APPEND)) {
+        return LDYNA_CONCURRENT_WARN;
+    }
     if (!list || !list->array || !data) {
         return LDYNA_NULLPTR_WARN;
     }
@@ -189,6 +526,9 @@ int ldyna_insert(ldyna *list, void *data, size_t idx, ldyna_inbulk inbulk)
 
 int ldyna_remove(ldyna *list, size_t idx, void *data)
 {
+    if (list && (list->flags & LDYNA_CONCURRENT_APPEND)) {
+        return LDYNA_CONCURRENT_WARN;
+    }
     assert(list->len);
 
     if (!list || !list->array) {
@@ -205,6 +545,9 @@ int ldyna_remove(ldyna *list, size_t idx, void *data)
 
 int ldyna_index_of(ldyna *list, void *data, size_t *idx, ldyna_inbulk inbulk)
 {
+    if (list && (list->flags & LDYNA_CONCURRENT_APPEND)) {
+        return LDYNA_CONCURRENT_WARN;
+    }
     if (!list || !list->array || !data) {
         return LDYNA_NULLPTR_WARN;
     }
@@ -242,6 +585,20 @@ int ldyna_index_of(ldyna *list, void *data, size_t *idx, ldyna_inbulk inbulk)
 
 int ldyna_get(ldyna *list, size_t idx, void *data)
 {
+    if (list && (list->flags & LDYNA_CONCURRENT_APPEND)) {
+        if (!data || idx >= atomic_load_explicit(&list->segments->published, memory_order_acquire)) {
+            return LDYNA_NULLPTR_WARN;
+        }
+        if (!__slot_is_ready(list->segments, idx, list->esize)) {
+            return LDYNA_NOT_FOUND;
+        }
+        size_t offset;
+        size_t seg = __segment_index(idx, &offset);
+        ldyna_Byte *segment = __segment_get(list->segments, seg, list->esize, false);
+        memcpy(data, segment + offset * list->esize, list->esize);
+        return LDYNA_SUCCESS;
+    }
+
     assert(list->len);
 
     if (!list || !list->array || idx >= list->len) {
@@ -301,6 +658,9 @@ ldyna *ldyna_copy(ldyna *list, ldyna_inbulk inbulk)
 
 int ldyna_sort(ldyna *list, ldyna_compare compare)
 {
+    if (list && (list->flags & LDYNA_CONCURRENT_APPEND)) {
+        return LDYNA_CONCURRENT_WARN;
+    }
     if (!list || !list->array) {
         return LDYNA_NULLPTR_WARN;
     }
@@ -317,3 +677,187 @@ int ldyna_sort(ldyna *list, ldyna_compare compare)
     qsort(list->array, list->len, list->esize, compare);
     return LDYNA_SUCCESS;
 }
+
+int ldyna_nth_element(ldyna *list, size_t nth, ldyna_compare compare)
+{
+    if (list && (list->flags & LDYNA_CONCURRENT_APPEND)) {
+        return LDYNA_CONCURRENT_WARN;
+    }
+    if (!list || !list->array || nth >= list->len) {
+        return LDYNA_NULLPTR_WARN;
+    }
+
+    if (list->flags & LDYNA_SORT) {
+        // Reordering by another comparison would break the sorted list
+        if (compare && compare != list->compare) {
+            return LDYNA_COMPARE_WARN;
+        }
+        // A sorted list is already partitioned around every index
+        return LDYNA_SUCCESS;
+    }
+    if (!compare) {
+        compare = list->compare;
+    }
+
+    __introselect(list->array, list->len, nth, list->esize, compare);
+    return LDYNA_SUCCESS;
+}
+
+int ldyna_partial_sort(ldyna *list, size_t k, ldyna_compare compare)
+{
+    if (list && (list->flags & LDYNA_CONCURRENT_APPEND)) {
+        return LDYNA_CONCURRENT_WARN;
+    }
+    if (!list || !list->array) {
+        return LDYNA_NULLPTR_WARN;
+    }
+    if (list->flags & LDYNA_SORT) {
+        if (compare && compare != list->compare) {
+            return LDYNA_COMPARE_WARN;
+        }
+        return LDYNA_SUCCESS;
+    }
+    if (k > list->len) {
+        k = list->len;
+    }
+    if (!k) {
+        return LDYNA_SUCCESS;
+    }
+    if (!compare) {
+        compare = list->compare;
+    }
+
+    // Bring the k smallest objects to the front, then sort only those
+    if (k < list->len) {
+        __introselect(list->array, list->len, k - 1, list->esize, compare);
+    }
+    qsort(list->array, k, list->esize, compare);
+    return LDYNA_SUCCESS;
+}
+
+int ldyna_top_k_into(ldyna *list, size_t k, ldyna *out)
+{
+    if ((list && (list->flags & LDYNA_CONCURRENT_APPEND)) || (out && (out->flags & LDYNA_CONCURRENT_APPEND))) {
+        return LDYNA_CONCURRENT_WARN;
+    }
+    if (!list || !list->array || !out || !out->array) {
+        return LDYNA_NULLPTR_WARN;
+    }
+    assert(list != out);
+    if (list->esize != out->esize) {
+        return LDYNA_ESIZE_WARN;
+    }
+    // A sorted 'out' receives the objects in ascending order, which is
+    // only sorted for it if both lists compare alike
+    if ((out->flags & LDYNA_SORT) && out->compare != list->compare) {
+        return LDYNA_COMPARE_WARN;
+    }
+
+    if (k > list->len) {
+        k = list->len;
+    }
+    int res = __list_reserve(out, k);
+    if (res != LDYNA_SUCCESS) {
+        return res;
+    }
+    out->len = k;
+    if (!k) {
+        return LDYNA_SUCCESS;
+    }
+
+    size_t width = list->esize;
+
+    // Sorted list: the k greatest are the last k
+    if (list->flags & LDYNA_SORT) {
+        if (out->flags & LDYNA_SORT) {
+            memcpy(out->array, list->array + (list->len - k) * width, k * width);
+            return LDYNA_SUCCESS;
+        }
+        for (size_t i = 0; i < k; i++) {
+            memcpy(out->array + i * width, list->array + (list->len - 1 - i) * width, width);
+        }
+        return LDYNA_SUCCESS;
+    }
+
+    // Min-heap of the k greatest objects seen so far, root is the smallest
+    memcpy(out->array, list->array, k * width);
+    for (size_t i = k / 2; i-- > 0; ) {
+        __sift_down(out->array, k, i, width, -1, list->compare);
+    }
+    for (ldyna_Byte *ptr = list->array + k * width; ptr != list->array + list->len * width; ptr += width) {
+        if (list->compare(ptr, out->array) > 0) {
+            memcpy(out->array, ptr, width);
+            __sift_down(out->array, k, 0, width, -1, list->compare);
+        }
+    }
+
+    // Heapsort with a min-heap leaves the objects greatest first
+    for (size_t n = k; n > 1; n--) {
+        __swap(out->array, out->array + (n - 1) * width, width);
+        __sift_down(out->array, n - 1, 0, width, -1, list->compare);
+    }
+    if (out->flags & LDYNA_SORT) {
+        for (size_t i = 0; i < k / 2; i++) {
+            __swap(out->array + i * width, out->array + (k - 1 - i) * width, width);
+        }
+    }
+    return LDYNA_SUCCESS;
+}
+
+int ldyna_compact(ldyna *list)
+{
+    if (!list) {
+        return LDYNA_NULLPTR_WARN;
+    }
+    if (!(list->flags & LDYNA_CONCURRENT_APPEND)) {
+        return LDYNA_SUCCESS;
+    }
+
+    struct _ldyna_segments *segments = list->segments;
+    size_t published = atomic_load_explicit(&segments->published, memory_order_acquire);
+    if (published != atomic_load_explicit(&segments->reserved, memory_order_relaxed)) {
+        return LDYNA_CONCURRENT_WARN;
+    }
+
+    // Tombstones of failed appends are dropped
+    size_t len = 0;
+    for (size_t idx = 0; idx < published; idx++) {
+        len += __slot_is_ready(segments, idx, list->esize);
+    }
+
+    // The contiguous array starts empty, so this allocates it
+    int res = __list_reserve(list, len ? len : 1);
+    if (res != LDYNA_SUCCESS) {
+        return res;
+    }
+
+    // Copy the runs of ready slots, a whole segment at once without failures
+    size_t copied = 0;
+    for (size_t idx = 0; idx < published; ) {
+        if (!__slot_is_ready(segments, idx, list->esize)) {
+            idx++;
+            continue;
+        }
+        size_t offset;
+        size_t seg = __segment_index(idx, &offset);
+        size_t run = 1;
+        while (offset + run < __segment_capacity(seg) && idx + run < published
+               && __slot_is_ready(segments, idx + run, list->esize)) {
+            run++;
+        }
+        ldyna_Byte *segment = atomic_load_explicit(&segments->dir[seg], memory_order_acquire);
+        memcpy(list->array + copied * list->esize, segment + offset * list->esize, run * list->esize);
+        copied += run;
+        idx += run;
+    }
+    __segments_free(segments);
+
+    list->segments = NULL;
+    list->len = len;
+    list->flags &= ~LDYNA_CONCURRENT_APPEND;
+
+    if (list->flags & LDYNA_SORT) {
+        return ldyna_sort(list, NULL);
+    }
+    return LDYNA_SUCCESS;
+}
@@ -18,6 +18,7 @@ typedef struct {
 typedef enum {
     LDYNA_NONE = 0,
     LDYNA_SORT = 1 << 0,
+    LDYNA_CONCURRENT_APPEND = 1 << 1,
     // TODO: LDYNA_THREAD_SAFE
 } ldyna_flags;
 
@@ -27,6 +28,9 @@ enum {
     LDYNA_NULLPTR_WARN,
     LDYNA_INBULK_WARN,
     LDYNA_REALLOC_ERR,
+    LDYNA_CONCURRENT_WARN,
+    LDYNA_COMPARE_WARN,
+    LDYNA_ESIZE_WARN,
 };
 
 //---------------------------------
@@ -42,6 +46,9 @@ enum {
  *         any  dynamic  allocated  memory  upon   exit.  The
  *         memory allocated by this function can be  released
  *         with a call to ldyna_destroy (see below).
+ *         With the LDYNA_CONCURRENT_APPEND flag  the  list is
+ *         created in concurrent append mode (see ldyna_compact
+ *         below).
  *
  * \param compare  the pointer to compare function
  * \param flags    the initial flags
@@ -72,7 +79,15 @@ extern int ldyna_destroy(ldyna **list);
 extern size_t ldyna_len(ldyna *list);
 
 /************************************************************
- * \brief  Appends an object to the list.
+ * \brief  Appends an object to the list.  In concurrent append
+ *         mode this can be called from several threads at once
+ *         without external locking. There, if the storage for
+ *         the object cannot be allocated, only its  slot becomes
+ *         a tombstone, once the earlier appends are  published:
+ *         it is still counted by ldyna_len, so later appends are
+ *         published, ldyna_get returns LDYNA_NOT_FOUND for it and
+ *         ldyna_compact drops it. The next appends retry the
+ *         allocation.
  *
  * \param list  the list to which the object will be appended
  * \param data  the object to be appended
@@ -81,6 +96,8 @@ extern size_t ldyna_len(ldyna *list);
  * \return LDYNA_SUCCESS       if successful
  * \return LDYNA_NULLPTR_WARN  if list is NULL or data is
  *                                 NULL
+ * \return LDYNA_REALLOC_ERR   if the storage could not be grown,
+ *                                 the object was not added
  ************************************************************/
 extern int ldyna_append(ldyna *list, void *data, ldyna_inbulk inbulk);
 
@@ -138,7 +155,9 @@ extern int ldyna_index_of(ldyna *list, void *data, size_t *idx, ldyna_inbulk inb
  * \brief  Returns the object at index 'idx' in  the  dynamic
  *         array. The object continues in the  list. if 'idx'
  *         is out of range,  returns the  last element in the
- *         array.
+ *         array. In concurrent append mode  only  the  published
+ *         indices (below ldyna_len) can be read, without locks,
+ *         while other threads keep appending.
  *
  * \param list  the dyamic array
  * \param idx   the index in which the desired object is
@@ -148,6 +167,8 @@ extern int ldyna_index_of(ldyna *list, void *data, size_t *idx, ldyna_inbulk inb
  * \return  LDYNA_SUCCESS       if successful
  * \return  LDYNA_NULLPTR_WARN  if list is NULL  or 'idx'
  *                                  out of the list range
+ * \return  LDYNA_NOT_FOUND     if 'idx' is a tombstone (in
+ *                                  concurrent append mode)
  ************************************************************/
 extern int ldyna_get(ldyna *list, size_t idx, void *data);
 
@@ -209,4 +230,103 @@ extern ldyna *ldyna_copy(ldyna *list, ldyna_inbulk inbulk);
  ************************************************************/
 extern int ldyna_sort(ldyna *list, ldyna_compare compare);
 
+/************************************************************
+ * \brief  Rearranges the dynamic array so that the object at
+ *         index 'nth' is the one that would be there if  the
+ *         array were sorted. Every object before 'nth' compares
+ *         less than or equal to it and every object after  it
+ *         compares greater than or equal to it. Runs in  place
+ *         in linear time on average (introselect).
+ *         NOTE: on a sorted list this is a no-op, and any other
+ *         comparison than the list's one is rejected.
+ *
+ * \param list     the dynamic array to be rearranged
+ * \param nth      the index of the element to be selected
+ * \param compare  the comparison function, or NULL to use the
+ *                 list's comparison function
+ *
+ * \return LDYNA_SUCCESS       if successful
+ * \return LDYNA_NULLPTR_WARN  if list is NULL or 'nth' is out
+ *                                 of the list range
+ * \return LDYNA_COMPARE_WARN  if list is a sorted list and
+ *                                 compare is not its comparison
+ ************************************************************/
+extern int ldyna_nth_element(ldyna *list, size_t nth, ldyna_compare compare);
+
+/************************************************************
+ * \brief  Sorts only the first 'k' positions of the  dynamic
+ *         array: after the call they hold the 'k' smallest
+ *         objects in ascending order. The order of the
+ *         remaining objects is unspecified. If 'k' is greater
+ *         than the list length, the whole list is sorted.
+ *         Non-stable sorting. As with ldyna_nth_element, this
+ *         is a no-op on a sorted list.
+ *
+ * \param list     the dynamic array to be partially sorted
+ * \param k        the number of leading positions to sort
+ * \param compare  the comparison function, or NULL to use the
+ *                 list's comparison function
+ *
+ * \return LDYNA_SUCCESS       if successful
+ * \return LDYNA_NULLPTR_WARN  if list is NULL
+ * \return LDYNA_COMPARE_WARN  if list is a sorted list and
+ *                                 compare is not its comparison
+ ************************************************************/
+extern int ldyna_partial_sort(ldyna *list, size_t k, ldyna_compare compare);
+
+/************************************************************
+ * \brief  Copies the 'k' greatest objects of the dynamic array,
+ *         according to the list's comparison function,  into
+ *         'out', greatest first. The previous contents of 'out'
+ *         are discarded. The source list is  left  untouched
+ *         and only O(k) extra memory is used (bounded heap).
+ *         If 'k' is greater than the list length,  the  whole
+ *         list is copied. 'out' must store objects of the same
+ *         size as 'list'. If 'out' is a sorted list, the
+ *         objects are stored in ascending order instead, and
+ *         'out' must use the same comparison function as 'list'.
+ *
+ * \param list  the dynamic array to be searched
+ * \param k     the number of objects to be selected
+ * \param out   the dynamic array that receives the selected
+ *              objects
+ *
+ * \return LDYNA_SUCCESS       if successful
+ * \return LDYNA_NULLPTR_WARN  if list or out is NULL
+ * \return LDYNA_REALLOC_ERR   if 'out' could not be grown
+ * \return LDYNA_COMPARE_WARN  if 'out' is a sorted list with a
+ *                                 different comparison function
+ * \return LDYNA_ESIZE_WARN    if 'out' stores objects of another
+ *                                 size than 'list'
+ ************************************************************/
+extern int ldyna_top_k_into(ldyna *list, size_t k, ldyna *out);
+
+/************************************************************
+ * \brief  Leaves the concurrent append mode: the segments  of
+ *         a list created with LDYNA_CONCURRENT_APPEND are
+ *         flattened into the normal contiguous layout, so that
+ *         the whole interface can be used again. If the list is
+ *         a sorted list, it is sorted as well.  Tombstones of
+ *         failed appends are dropped. Must be called only once
+ *         every producer has finished appending  and  every
+ *         reader has stopped calling ldyna_get and ldyna_len:
+ *         the segments are released by this call.
+ *         Does nothing on a list that is not  in  concurrent
+ *         append mode.
+ *         NOTE: while in concurrent append mode, only
+ *         ldyna_append, ldyna_get, ldyna_len, ldyna_compact and
+ *         ldyna_destroy can be used; the other functions return
+ *         LDYNA_CONCURRENT_WARN (or NULL).
+ *
+ * \param list  the dynamic array to be compacted
+ *
+ * \return LDYNA_SUCCESS          if successful
+ * \return LDYNA_NULLPTR_WARN     if list is NULL
+ * \return LDYNA_CONCURRENT_WARN  if some append is still in
+ *                                    progress
+ * \return LDYNA_REALLOC_ERR      if the contiguous storage could
+ *                                    not be allocated
+ ************************************************************/
+extern int ldyna_compact(ldyna *list);
+
 #endif
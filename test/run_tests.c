@@ -4,17 +4,19 @@
 #include <stdio.h>
 #include <stdlib.h>
 
-#define NTHREADS 2U
+#define NTHREADS 4U
 #define ERROR(stream, msg) fprintf(stream, "[%s:%lu]: %s\n", __FILE__, __LINE__+0UL, msg)
 
 typedef void *(*ldyna_test_fn)(void *);
 
 void *ldyna_test_int(void *);
 void *ldyna_test_sorted_int(void *);
+void *ldyna_test_select_int(void *);
+void *ldyna_test_concurrent_int(void *);
 
 int main(void)
 {
-    const ldyna_test_fn functions[] = { ldyna_test_int, ldyna_test_sorted_int, };
+    const ldyna_test_fn functions[] = { ldyna_test_int, ldyna_test_sorted_int, ldyna_test_select_int, ldyna_test_concurrent_int, };
 
     pthread_t threads[NTHREADS];
     for (size_t i = 0; i < NTHREADS; i++) {
@@ -0,0 +1,140 @@
+// ldyna simplified concurrent append int test
+#include "../src/ldyna.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#define NTESTS 1000U
+#define NPRODUCERS 4U
+
+#define TEST(msg) printf("[%s]: %s\n", __FILE__, msg)
+
+static int compare_int(const void *key1, const void *key2)
+{
+    return (*(int *) key1) - (*(int *) key2);
+}
+
+typedef struct {
+    ldyna *list;
+    unsigned producer;
+} producer_args;
+
+static void *produce(void *args)
+{
+    producer_args *pargs = args;
+    ldyna_inbulk inbulk = { .inbulk = false };
+    for (size_t i = 0; i < NTESTS; i++) {
+        int elem = (int) (pargs->producer * NTESTS + i);
+        assert(ldyna_append(pargs->list, &elem, inbulk) == LDYNA_SUCCESS);
+    }
+    return NULL;
+}
+
+void *ldyna_test_concurrent_int(void *args)
+{
+    ldyna *list = ldyna_create(sizeof(int), compare_int, LDYNA_CONCURRENT_APPEND);
+
+    assert(list != NULL);
+
+    pthread_t threads[NPRODUCERS];
+    producer_args pargs[NPRODUCERS];
+    for (unsigned p = 0; p < NPRODUCERS; p++) {
+        pargs[p] = (producer_args) { .list = list, .producer = p };
+        assert(pthread_create(&threads[p], NULL, produce, &pargs[p]) == 0);
+    }
+
+    // Read the published objects while the producers keep appending
+    size_t len;
+    while ((len = ldyna_len(list)) < NPRODUCERS * NTESTS) {
+        for (size_t i = 0; i < len; i++) {
+            int data;
+            assert(ldyna_get(list, i, &data) == LDYNA_SUCCESS);
+            assert(data >= 0 && data < (int) (NPRODUCERS * NTESTS));
+        }
+    }
+
+    for (unsigned p = 0; p < NPRODUCERS; p++) {
+        pthread_join(threads[p], NULL);
+    }
+    assert(ldyna_len(list) == NPRODUCERS * NTESTS);
+
+    // Only appending and reading are allowed until the list is compacted
+    ldyna_inbulk inbulk = { .inbulk = false };
+    int elem = 0;
+    size_t idx;
+    ldyna *out = ldyna_create(sizeof(int), compare_int, LDYNA_NONE);
+    assert(out != NULL);
+    assert(ldyna_insert(list, &elem, 0, inbulk) == LDYNA_CONCURRENT_WARN);
+    assert(ldyna_remove(list, 0, &elem) == LDYNA_CONCURRENT_WARN);
+    assert(ldyna_index_of(list, &elem, &idx, inbulk) == LDYNA_CONCURRENT_WARN);
+    assert(ldyna_sort(list, NULL) == LDYNA_CONCURRENT_WARN);
+    assert(ldyna_nth_element(list, 0, NULL) == LDYNA_CONCURRENT_WARN);
+    assert(ldyna_partial_sort(list, 1, NULL) == LDYNA_CONCURRENT_WARN);
+    assert(ldyna_top_k_into(list, 1, out) == LDYNA_CONCURRENT_WARN);
+    assert(ldyna_top_k_into(out, 1, list) == LDYNA_CONCURRENT_WARN);
+    assert(ldyna_copy(list, inbulk) == NULL);
+    ldyna_destroy(&out);
+
+    // Every producer's objects keep their relative order
+    int last[NPRODUCERS];
+    for (unsigned p = 0; p < NPRODUCERS; p++) {
+        last[p] = -1;
+    }
+    assert(ldyna_compact(list) == LDYNA_SUCCESS);
+    assert(ldyna_len(list) == NPRODUCERS * NTESTS);
+    for (size_t i = 0; i < NPRODUCERS * NTESTS; i++) {
+        int data;
+        assert(ldyna_get(list, i, &data) == LDYNA_SUCCESS);
+        unsigned p = data / NTESTS;
+        assert(last[p] < data);
+        last[p] = data;
+    }
+
+    assert(ldyna_sort(list, compare_int) == LDYNA_SUCCESS);
+    for (size_t i = 0; i < NPRODUCERS * NTESTS; i++) {
+        int data;
+        assert(ldyna_get(list, i, &data) == LDYNA_SUCCESS);
+        assert(data == (int) i);
+    }
+
+    ldyna_destroy(&list);
+
+    // Compacting an empty list leaves a usable one
+    list = ldyna_create(sizeof(int), compare_int, LDYNA_CONCURRENT_APPEND);
+    assert(list != NULL);
+    assert(ldyna_len(list) == 0);
+    assert(ldyna_compact(list) == LDYNA_SUCCESS);
+    assert(ldyna_len(list) == 0);
+    assert(ldyna_compact(list) == LDYNA_SUCCESS);
+    elem = 1;
+    assert(ldyna_append(list, &elem, inbulk) == LDYNA_SUCCESS);
+    assert(ldyna_len(list) == 1);
+    ldyna_destroy(&list);
+
+    // A sorted list is sorted on compaction
+    list = ldyna_create(sizeof(int), compare_int, LDYNA_SORT | LDYNA_CONCURRENT_APPEND);
+    assert(list != NULL);
+    for (unsigned p = 0; p < NPRODUCERS; p++) {
+        pargs[p].list = list;
+        assert(pthread_create(&threads[p], NULL, produce, &pargs[p]) == 0);
+    }
+    for (unsigned p = 0; p < NPRODUCERS; p++) {
+        pthread_join(threads[p], NULL);
+    }
+    assert(ldyna_compact(list) == LDYNA_SUCCESS);
+    assert(ldyna_len(list) == NPRODUCERS * NTESTS);
+    for (size_t i = 0; i < NPRODUCERS * NTESTS; i++) {
+        int data;
+        assert(ldyna_get(list, i, &data) == LDYNA_SUCCESS);
+        assert(data == (int) i);
+    }
+    elem = (int) (NPRODUCERS * NTESTS);
+    assert(ldyna_append(list, &elem, inbulk) == LDYNA_SUCCESS);
+    assert(ldyna_index_of(list, &elem, &idx, inbulk) == LDYNA_SUCCESS);
+    assert(idx == NPRODUCERS * NTESTS);
+    ldyna_destroy(&list);
+
+    TEST("*** All tests passed");
+
+    return NULL;
+}
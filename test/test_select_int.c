@@ -0,0 +1,224 @@
+// ldyna simplified selection int test
+#include "../src/ldyna.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <limits.h>
+#define NTESTS 1000U
+#define TOPK 10U
+
+#define TEST(msg) printf("[%s]: %s\n", __FILE__, msg)
+
+static int compare_int(const void *key1, const void *key2)
+{
+    return (*(int *) key1) - (*(int *) key2);
+}
+
+static int compare_int_reverse(const void *key1, const void *key2)
+{
+    return (*(int *) key2) - (*(int *) key1);
+}
+
+// Answers with the extreme values a subtraction may produce
+static int compare_int_extreme(const void *key1, const void *key2)
+{
+    int x = *(int *) key1;
+    int y = *(int *) key2;
+    return x < y ? INT_MIN : x > y ? INT_MAX : 0;
+}
+
+// McIlroy's adversary: objects are indices whose values are fixed only
+// when compared, so that every partitioning picks a bad pivot and the
+// introselect has to fall back to heap select.
+static int adversary_values[NTESTS];
+static int adversary_solid;
+static int adversary_candidate;
+#define ADVERSARY_GAS ((int) NTESTS)
+
+static int compare_adversary(const void *key1, const void *key2)
+{
+    int x = *(int *) key1;
+    int y = *(int *) key2;
+    if (adversary_values[x] == ADVERSARY_GAS && adversary_values[y] == ADVERSARY_GAS) {
+        adversary_values[x == adversary_candidate ? x : y] = adversary_solid++;
+    }
+    if (adversary_values[x] == ADVERSARY_GAS) {
+        adversary_candidate = x;
+    }
+    else if (adversary_values[y] == ADVERSARY_GAS) {
+        adversary_candidate = y;
+    }
+    return adversary_values[x] - adversary_values[y];
+}
+
+void *ldyna_test_select_int(void *args)
+{
+    ldyna *list = ldyna_create(sizeof(int), compare_int, LDYNA_NONE);
+
+    assert(list != NULL);
+
+    ldyna_inbulk inbulk = { .inbulk = false };
+    int numbers[NTESTS];
+    for (size_t i = 0; i < NTESTS; i++) {
+        int elem = rand() % 100 + 1;
+        numbers[i] = elem;
+        assert(ldyna_append(list, &elem, inbulk) == LDYNA_SUCCESS);
+    }
+    qsort(numbers, NTESTS, sizeof(numbers[0]), compare_int);
+
+    ldyna *top = ldyna_create(sizeof(int), compare_int, LDYNA_NONE);
+    assert(top != NULL);
+    assert(ldyna_top_k_into(list, TOPK, top) == LDYNA_SUCCESS);
+    assert(ldyna_len(top) == TOPK);
+    for (size_t i = 0; i < TOPK; i++) {
+        int data;
+        assert(ldyna_get(top, i, &data) == LDYNA_SUCCESS);
+        assert(data == numbers[NTESTS - 1 - i]);
+    }
+
+    size_t nth = NTESTS / 2;
+    assert(ldyna_nth_element(list, nth, NULL) == LDYNA_SUCCESS);
+    int median;
+    assert(ldyna_get(list, nth, &median) == LDYNA_SUCCESS);
+    assert(median == numbers[nth]);
+    for (size_t i = 0; i < NTESTS; i++) {
+        int data;
+        assert(ldyna_get(list, i, &data) == LDYNA_SUCCESS);
+        assert(i < nth ? data <= median : data >= median);
+    }
+    assert(ldyna_nth_element(list, NTESTS, NULL) == LDYNA_NULLPTR_WARN);
+
+    assert(ldyna_partial_sort(list, TOPK, NULL) == LDYNA_SUCCESS);
+    for (size_t i = 0; i < TOPK; i++) {
+        int data;
+        assert(ldyna_get(list, i, &data) == LDYNA_SUCCESS);
+        assert(data == numbers[i]);
+    }
+
+    assert(ldyna_partial_sort(list, NTESTS + 1, NULL) == LDYNA_SUCCESS);
+    for (size_t i = 0; i < NTESTS; i++) {
+        int data;
+        assert(ldyna_get(list, i, &data) == LDYNA_SUCCESS);
+        assert(data == numbers[i]);
+    }
+
+    // Explicit comparison function
+    assert(ldyna_nth_element(list, 0, compare_int_reverse) == LDYNA_SUCCESS);
+    int data;
+    assert(ldyna_get(list, 0, &data) == LDYNA_SUCCESS);
+    assert(data == numbers[NTESTS - 1]);
+    assert(ldyna_partial_sort(list, TOPK, compare_int_reverse) == LDYNA_SUCCESS);
+    for (size_t i = 0; i < TOPK; i++) {
+        assert(ldyna_get(list, i, &data) == LDYNA_SUCCESS);
+        assert(data == numbers[NTESTS - 1 - i]);
+    }
+
+    // k == 0 and k > len
+    assert(ldyna_partial_sort(list, 0, NULL) == LDYNA_SUCCESS);
+    assert(ldyna_top_k_into(list, 0, top) == LDYNA_SUCCESS);
+    assert(ldyna_len(top) == 0);
+    assert(ldyna_top_k_into(list, NTESTS + 1, top) == LDYNA_SUCCESS);
+    assert(ldyna_len(top) == NTESTS);
+    for (size_t i = 0; i < NTESTS; i++) {
+        assert(ldyna_get(top, i, &data) == LDYNA_SUCCESS);
+        assert(data == numbers[NTESTS - 1 - i]);
+    }
+
+    // Sorted lists: shortcuts and comparisons that would unsort them
+    ldyna *sorted = ldyna_create(sizeof(int), compare_int, LDYNA_SORT);
+    assert(sorted != NULL);
+    for (size_t i = 0; i < NTESTS; i++) {
+        assert(ldyna_append(sorted, &numbers[i], inbulk) == LDYNA_SUCCESS);
+    }
+    assert(ldyna_nth_element(sorted, nth, NULL) == LDYNA_SUCCESS);
+    assert(ldyna_nth_element(sorted, nth, compare_int) == LDYNA_SUCCESS);
+    assert(ldyna_nth_element(sorted, nth, compare_int_reverse) == LDYNA_COMPARE_WARN);
+    assert(ldyna_partial_sort(sorted, TOPK, NULL) == LDYNA_SUCCESS);
+    assert(ldyna_partial_sort(sorted, TOPK, compare_int_reverse) == LDYNA_COMPARE_WARN);
+    for (size_t i = 0; i < NTESTS; i++) {
+        assert(ldyna_get(sorted, i, &data) == LDYNA_SUCCESS);
+        assert(data == numbers[i]);
+    }
+    assert(ldyna_top_k_into(sorted, TOPK, top) == LDYNA_SUCCESS);
+    assert(ldyna_len(top) == TOPK);
+    for (size_t i = 0; i < TOPK; i++) {
+        assert(ldyna_get(top, i, &data) == LDYNA_SUCCESS);
+        assert(data == numbers[NTESTS - 1 - i]);
+    }
+
+    // A sorted 'out' is filled in ascending order and stays sorted
+    ldyna *sortedtop = ldyna_create(sizeof(int), compare_int, LDYNA_SORT);
+    assert(sortedtop != NULL);
+    assert(ldyna_top_k_into(list, TOPK, sortedtop) == LDYNA_SUCCESS);
+    for (size_t i = 0; i < TOPK; i++) {
+        assert(ldyna_get(sortedtop, i, &data) == LDYNA_SUCCESS);
+        assert(data == numbers[NTESTS - TOPK + i]);
+    }
+    assert(ldyna_top_k_into(sorted, TOPK, sortedtop) == LDYNA_SUCCESS);
+    for (size_t i = 0; i < TOPK; i++) {
+        assert(ldyna_get(sortedtop, i, &data) == LDYNA_SUCCESS);
+        assert(data == numbers[NTESTS - TOPK + i]);
+    }
+    int greatest = numbers[NTESTS - 1] + 1;
+    assert(ldyna_append(sortedtop, &greatest, inbulk) == LDYNA_SUCCESS);
+    assert(ldyna_get(sortedtop, TOPK, &data) == LDYNA_SUCCESS);
+    assert(data == greatest);
+    size_t idx;
+    assert(ldyna_index_of(sortedtop, &numbers[NTESTS - 1], &idx, inbulk) == LDYNA_SUCCESS);
+    ldyna *reversetop = ldyna_create(sizeof(int), compare_int_reverse, LDYNA_SORT);
+    assert(reversetop != NULL);
+    assert(ldyna_top_k_into(list, TOPK, reversetop) == LDYNA_COMPARE_WARN);
+    // Comparison results at the limits of int
+    ldyna *extreme = ldyna_create(sizeof(int), compare_int_extreme, LDYNA_NONE);
+    assert(extreme != NULL);
+    ldyna *extremetop = ldyna_create(sizeof(int), compare_int_extreme, LDYNA_NONE);
+    assert(extremetop != NULL);
+    for (size_t i = 0; i < NTESTS; i++) {
+        assert(ldyna_append(extreme, &numbers[(i * 7) % NTESTS], inbulk) == LDYNA_SUCCESS);
+    }
+    assert(ldyna_top_k_into(extreme, TOPK, extremetop) == LDYNA_SUCCESS);
+    for (size_t i = 0; i < TOPK; i++) {
+        assert(ldyna_get(extremetop, i, &data) == LDYNA_SUCCESS);
+        assert(data == numbers[NTESTS - 1 - i]);
+    }
+    ldyna_destroy(&extremetop);
+    ldyna_destroy(&extreme);
+
+    ldyna *shorttop = ldyna_create(sizeof(short), NULL, LDYNA_NONE);
+    assert(shorttop != NULL);
+    assert(ldyna_top_k_into(list, TOPK, shorttop) == LDYNA_ESIZE_WARN);
+    ldyna_destroy(&shorttop);
+
+    // Adversarial input for the heap select fallback
+    ldyna *adversary = ldyna_create(sizeof(int), compare_adversary, LDYNA_NONE);
+    assert(adversary != NULL);
+    adversary_solid = 0;
+    adversary_candidate = 0;
+    for (int i = 0; i < (int) NTESTS; i++) {
+        adversary_values[i] = ADVERSARY_GAS;
+        assert(ldyna_append(adversary, &i, inbulk) == LDYNA_SUCCESS);
+    }
+    assert(ldyna_nth_element(adversary, nth, NULL) == LDYNA_SUCCESS);
+    int pivot;
+    assert(ldyna_get(adversary, nth, &pivot) == LDYNA_SUCCESS);
+    for (size_t i = 0; i < NTESTS; i++) {
+        assert(ldyna_get(adversary, i, &data) == LDYNA_SUCCESS);
+        assert(i < nth ? adversary_values[data] <= adversary_values[pivot]
+                       : adversary_values[data] >= adversary_values[pivot]);
+    }
+    size_t rank = 0;
+    for (size_t i = 0; i < NTESTS; i++) {
+        rank += adversary_values[i] < adversary_values[pivot];
+    }
+    assert(rank <= nth);
+
+    ldyna_destroy(&adversary);
+    ldyna_destroy(&reversetop);
+    ldyna_destroy(&sortedtop);
+    ldyna_destroy(&sorted);
+    ldyna_destroy(&top);
+    ldyna_destroy(&list);
+    TEST("*** All tests passed");
+
+    return NULL;
+}